@@ -0,0 +1,307 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------
+#   =========                 |
+#   \\      /  F ield         | OpenFOAM: The Open Source CFD Toolbox
+#    \\    /   O peration     |
+#     \\  /    A nd           | OpenQBMM - www.openqbmm.org
+#      \\/     M anipulation  |
+#------------------------------------------------------------------------------
+#     Copyright (C) 2019 Alberto Passalacqua
+#------------------------------------------------------------------------------
+# License
+#     This file is part of OpenQBMM, distributed under the terms of the GNU
+#     General Public License, version 3 or later. See COPYING.
+#
+# Script
+#     generateCoefficients.py
+#
+# Description
+#     Generate the coefficient tables of the Boltzmann collision kernel by
+#     expanding the analytical expressions of the collisional integrals in
+#     BoltzmannCollisionIntegrals.H into polynomials in omega, in the
+#     components of g and in those of u1, with exact rational coefficients.
+#
+#     Run from this directory:
+#
+#         ./generateCoefficients.py > BoltzmannCollisionCoefficients.C
+#
+#     The number of terms and the maximum exponent are printed on the error
+#     stream, and must match nTerms_ and maxExponent_ in BoltzmannCollision.H.
+#
+#------------------------------------------------------------------------------
+
+import re
+import sys
+from fractions import Fraction
+
+# Variables: omega, gx, gy, gz, u1x, u1y, u1z
+nVariables = 7
+
+# Kinds of integrals: zero order, and first order in x, y and z
+kinds = ['I', 'Ix', 'Iy', 'Iz']
+
+
+class Polynomial:
+    """Polynomial in the variables with rational coefficients, stored as a
+    dictionary from the tuple of exponents to the coefficient"""
+
+    def __init__(self, terms=None):
+        self.terms = terms or {}
+
+    @staticmethod
+    def constant(c):
+        if c == 0:
+            return Polynomial()
+        return Polynomial({(0,)*nVariables: Fraction(c)})
+
+    @staticmethod
+    def variable(i, n):
+        exponents = [0]*nVariables
+        exponents[i] = n
+        return Polynomial({tuple(exponents): Fraction(1)})
+
+    @staticmethod
+    def convert(other):
+        if isinstance(other, Polynomial):
+            return other
+        return Polynomial.constant(other)
+
+    def __add__(self, other):
+        terms = dict(self.terms)
+        for e, c in Polynomial.convert(other).terms.items():
+            terms[e] = terms.get(e, 0) + c
+            if terms[e] == 0:
+                del terms[e]
+        return Polynomial(terms)
+
+    __radd__ = __add__
+
+    def __neg__(self):
+        return Polynomial({e: -c for e, c in self.terms.items()})
+
+    def __pos__(self):
+        return self
+
+    def __sub__(self, other):
+        return self + (-Polynomial.convert(other))
+
+    def __rsub__(self, other):
+        return Polynomial.convert(other) - self
+
+    def __mul__(self, other):
+        terms = {}
+        for e1, c1 in self.terms.items():
+            for e2, c2 in Polynomial.convert(other).terms.items():
+                e = tuple(a + b for a, b in zip(e1, e2))
+                terms[e] = terms.get(e, 0) + c1*c2
+                if terms[e] == 0:
+                    del terms[e]
+        return Polynomial(terms)
+
+    __rmul__ = __mul__
+
+    def __truediv__(self, other):
+        return self*(1/Fraction(other))
+
+
+def sqr(x):
+    return x*x
+
+
+def pow3(x):
+    return x*x*x
+
+
+def componentPower(offset):
+    """Replacement of the power of a vector component by a variable"""
+
+    components = {'x': 0, 'y': 1, 'z': 2}
+
+    return lambda m: 'P.variable(%d, %s)' % (
+        offset + components[m.group(2)], m.group(1)
+    )
+
+
+def translate(expr):
+    """Translate a C++ expression of an integral into Python"""
+
+    expr = expr.replace(
+        '(gPow[2] & gPow[2])',
+        '(P.variable(1, 4) + P.variable(2, 4) + P.variable(3, 4))'
+    )
+    expr = expr.replace(
+        'gMagSqr',
+        '(P.variable(1, 2) + P.variable(2, 2) + P.variable(3, 2))'
+    )
+    expr = re.sub(r'omegaPow\[(\d)\]', r'P.variable(0, \1)', expr)
+    expr = re.sub(r'gPow\[(\d)\]\.([xyz])\(\)', componentPower(1), expr)
+    expr = re.sub(r'vPow\[(\d)\]\.([xyz])\(\)', componentPower(4), expr)
+
+    # Constants are converted to exact fractions
+    return re.sub(r'(?<![\w.])(\d+\.\d*)', r'Fraction("\1")', expr)
+
+
+def readIntegrals(fileName):
+    """Return the velocity moment orders of the integrals, in the order of
+    the table of integrals, and the polynomial of each integral"""
+
+    source = open(fileName).read()
+    symbols = {'P': Polynomial, 'Fraction': Fraction, 'sqr': sqr, 'pow3': pow3}
+
+    polynomials = {}
+
+    for m in re.finditer(
+        r'integralFunction\((\w+),(\d),(\d),(\d)\)\s*\{\s*return(.*?);\s*\}',
+        source,
+        re.S
+    ):
+        order = tuple(int(m.group(i)) for i in (2, 3, 4))
+        value = eval(translate(' '.join(m.group(5).split())), symbols)
+        polynomials[(m.group(1), order)] = Polynomial.convert(value)
+
+    orders = [
+        tuple(int(m.group(i)) for i in (1, 2, 3))
+        for m in re.finditer(r'integralEntry\((\d),(\d),(\d)\)', source)
+    ]
+
+    for kind in kinds:
+        for order in orders:
+            if (kind, order) not in polynomials:
+                sys.exit('No expression for %s%s' % (kind, order))
+
+    return orders, polynomials
+
+
+def coefficient(c):
+    if c.denominator == 1:
+        return '%d.0' % c.numerator
+    return '%d.0/%d.0' % (c.numerator, c.denominator)
+
+
+header = r'''/*---------------------------------------------------------------------------*\
+  =========                 |
+  \\      /  F ield         | OpenFOAM: The Open Source CFD Toolbox
+   \\    /   O peration     |
+    \\  /    A nd           | OpenQBMM - www.openqbmm.org
+     \\/     M anipulation  |
+-------------------------------------------------------------------------------
+    Copyright (C) 2019 Alberto Passalacqua
+-------------------------------------------------------------------------------
+License
+    This file is derivative work of OpenFOAM.
+
+    OpenFOAM is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpenFOAM is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OpenFOAM.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "BoltzmannCollision.H"
+
+// * * * * * * * * * * * * * * Static Data Members * * * * * * * * * * * * * //
+'''
+
+className = \
+    'Foam::populationBalanceSubModels::collisionKernels::BoltzmannCollision::'
+
+
+def main():
+    orders, polynomials = readIntegrals('BoltzmannCollisionIntegrals.H')
+
+    # Terms of each kind and integral, sorted by decreasing exponents of
+    # omega and then of the other variables
+    terms = []
+    offsets = [[] for kind in kinds]
+    maxExponent = 0
+
+    for kindi, kind in enumerate(kinds):
+        for order in orders:
+            offsets[kindi].append(len(terms))
+            polynomial = polynomials[(kind, order)].terms
+
+            for e in sorted(polynomial, key=lambda e: [-x for x in e]):
+                terms.append((kind, order, polynomial[e], e))
+                maxExponent = max([maxExponent] + list(e))
+
+        offsets[kindi].append(len(terms))
+
+    out = [header]
+
+    for name in ['nIntegrals_', 'nTerms_', 'nVariables_', 'maxExponent_']:
+        out.append('\nconst Foam::label\n' + className + '\n' + name + ';\n')
+
+    out.append(
+        '\n\nconst Foam::label\n' + className
+      + '\nintegralOrders_[nIntegrals_][3] =\n{\n'
+      + ',\n'.join('    {%d, %d, %d}' % order for order in orders)
+      + '\n};\n'
+    )
+
+    blocks = []
+    for kindi, kind in enumerate(kinds):
+        rows = [
+            '        ' + ', '.join('%d' % o for o in offsets[kindi][i:i + 8])
+            for i in range(0, len(offsets[kindi]), 8)
+        ]
+        blocks.append(
+            '    // %s\n    {\n' % kind + ',\n'.join(rows) + '\n    }'
+        )
+
+    out.append(
+        '\n\nconst Foam::label\n' + className
+      + '\ntermOffsets_[4][nIntegrals_ + 1] =\n{\n'
+      + ',\n'.join(blocks)
+      + '\n};\n'
+    )
+
+    out.append(
+        '\n\n// Each term is {coefficient, {exponents of omega, gx, gy, gz, '
+        'u1x, u1y, u1z}},\n'
+        '// obtained by expanding the analytical expressions of the '
+        'integrals. The\n'
+        '// integrals with no terms are zero.\n'
+        'const ' + className + '\npolynomialTerm\n' + className
+      + '\nterms_[nTerms_] =\n{\n'
+    )
+
+    lines = []
+    previous = None
+    for termi, (kind, order, c, e) in enumerate(terms):
+        if (kind, order) != previous:
+            if previous is not None:
+                lines.append('')
+            lines.append('    // %s(%d,%d,%d)' % ((kind,) + order))
+            previous = (kind, order)
+
+        separator = ',' if termi < len(terms) - 1 else ''
+        lines.append(
+            '    {%s, {%s}}%s'
+          % (coefficient(c), ', '.join('%d' % x for x in e), separator)
+        )
+
+    out.append('\n'.join(lines) + '\n};\n')
+
+    out.append(
+        '\n\n// *************************************'
+        '************************************ //\n'
+    )
+
+    sys.stdout.write(''.join(out))
+
+    sys.stderr.write(
+        'nIntegrals_ = %d, nTerms_ = %d, maxExponent_ = %d\n'
+      % (len(orders), len(terms), maxExponent)
+    )
+
+
+if __name__ == '__main__':
+    main()